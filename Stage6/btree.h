@@ -0,0 +1,121 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include "index.h"
+
+// B+-tree index.
+//
+// A BTreeIndex maps the values of an INTEGER, FLOAT or STRING attribute
+// to the RIDs of the records holding them.  It is kept in a file of its
+// own, whose pages go through the buffer manager like those of a heap
+// file.  The first page of the file describes the tree; the others are
+// nodes.  Entries are ordered by value and then by RID, so a value may
+// occur any number of times and every entry can be found exactly.
+// Nodes split when they overflow but are not merged when they empty;
+// an emptied leaf just stays in the chain of leaves.
+
+// header page of an index file
+struct BTreeHdr
+{
+    int		attrType;	// type of the key
+    int		attrLen;	// length of the key in bytes
+    int		rootPage;	// page number of the root node
+    int		height;		// # of levels; the root is a leaf if 1
+};
+
+// a node.  An entry is the key, followed by a RID, followed by the
+// page number of a child in inner nodes.  Inner node entry i leads to
+// the entries not below it and below entry i+1; child0 leads to those
+// below entry 0.
+struct BTreeNode
+{
+    int		level;		// 0 for leaves
+    int		count;		// # of entries
+    int		next;		// next leaf, -1 for the last one
+    int		child0;		// inner nodes only
+    char	entries[1];
+};
+
+const int BTREEFIXED = 4 * sizeof(int);	// bytes of a node before entries
+
+
+// create an empty index file for keys of type and length
+extern const Status createBTree(const string & fileName,
+				const Datatype type, const int length);
+
+// destroy an index file
+extern const Status destroyBTree(const string & fileName);
+
+
+class BTreeIndex : public AttrIndex
+{
+public:
+    // open the index in file fileName
+    BTreeIndex(const string & fileName, Status & status);
+
+    // ends a scan that is going on and closes the file
+    ~BTreeIndex();
+
+    // returns NONUNIQUEENTRY if the entry is in the index already
+    const Status insertEntry(const void* key, const RID & rid);
+    const Status deleteEntry(const void* key, const RID & rid);
+
+    // any operator but NE can be scanned for.  Entries come in key
+    // order.
+    const Status startScan(const void* value, const Operator op);
+    const Status scanNext(RID & outRid);
+    const Status endScan();
+
+private:
+    File*	file;
+    int		hdrPageNo;
+    BTreeHdr*	hdr;		// pinned header page
+    bool	hdrDirty;
+
+    int		entrySize;	// bytes of an entry
+    int		capacity;	// max. # of entries of a node
+
+    // the scan
+    Operator	scanOp;
+    vector<char> scanKey;	// the value, as long as a key
+    BTreeNode*	scanLeaf;	// pinned leaf, NULL if none
+    int		scanLeafNo;
+    int		scanPos;	// next entry of scanLeaf
+
+    char* entry(BTreeNode* node, const int i) const
+	{ return node->entries + i * entrySize; }
+
+    // compare key a with key b, and then ridA with ridB if both are
+    // given
+    int compare(const char* a, const char* b) const;
+    int compare(const char* a, const RID* ridA,
+		const char* b, const RID* ridB) const;
+
+    // position of the first entry of node not below key and rid, or
+    // with after set, the first one above them.  With rid NULL only
+    // the keys are compared.
+    int search(BTreeNode* node, const char* key, const RID* rid,
+	       const bool after) const;
+
+    // the child of inner node node to look for key and rid in, as for
+    // search; the first child if key is NULL
+    int childFor(BTreeNode* node, const char* key, const RID* rid,
+		 const bool after) const;
+
+    // the leaf to look for key and rid in, and the page numbers of the
+    // inner nodes on the way to it, root first
+    const Status findLeaf(const char* key, const RID* rid, const bool after,
+			  int & leafNo, vector<int> & path);
+
+    // put an entry, whose child is childNo, at position pos of node
+    void putEntry(BTreeNode* node, const int pos, const char* key,
+		  const RID & rid, const int childNo);
+
+    // split node into itself and a new node to its right, newNode,
+    // which is left pinned, and return the entry that goes in the
+    // parent in sepKey and sepRid
+    const Status split(BTreeNode* node, int & newNo, BTreeNode*& newNode,
+		       char* sepKey, RID & sepRid);
+};
+
+#endif
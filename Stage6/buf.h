@@ -1,31 +1,60 @@
 #ifndef BUF_H
 #define BUF_H
 
+#include <pthread.h>
+#include <deque>
 #include "db.h"
+#include "page.h"
+#include "ioqueue.h"
 // define if debug output wanted
 //#define DEBUGBUF
 
 // declarations for buffer pool hash table
 struct hashBucket
 {
-	File*	file;    // pointer a file object (more on this below)
+	const File*	file;    // pointer a file object (more on this below)
 	int	pageNo;  // page number within a file
 	int	frameNo; // frame number of page in the buffer pool
-	hashBucket* 	next;	 // next node in the hash table
 };
 
 
-// hash table to keep track of pages in the buffer pool
+// number of independently latched partitions of the buffer hash table
+const int HTPARTS = 16;
+
+// hash table to keep track of pages in the buffer pool.
+// The table is split into HTPARTS partitions, each protected by its
+// own latch, so that threads working on unrelated pages do not serialize
+// on a single lock.  insert, lookup and remove must be called with the
+// partition of (file,pageNo) latched via lockPartition().
+//
+// Each partition is a contiguous array of buckets using open addressing
+// with linear probing.  The buckets are allocated once in the constructor,
+// so inserting and removing pages never touches the allocator.  Removal
+// shifts the following entries of the probe sequence back instead of
+// leaving tombstones, so probe sequences stay short.
 class BufHashTbl
 {
 private:
-    int HTSIZE;
-    hashBucket**  ht; // actual hash table
-    int	 hash(const File* file, const int pageNo); // returns value between 0 and HTSIZE-1
+    struct Partition
+    {
+	hashBucket*	 bucket;  // the buckets of this partition
+	unsigned int	 mask;    // number of buckets - 1 (a power of 2)
+	pthread_mutex_t latch;   // protects the buckets
+    };
+
+    Partition part[HTPARTS];
+
+    // 64-bit mix of (file,pageNo).  The high bits select the partition,
+    // the low bits the home bucket within the partition.
+    static unsigned long long hash(const File* file, const int pageNo);
 
 public:
-    BufHashTbl(const int htSize);  // constructor
+    BufHashTbl(const int bufs);  // constructor; bufs is the pool size
     ~BufHashTbl(); // destructor
+
+    // latch and unlatch the partition that (file,pageNo) belongs to
+    void lockPartition(const File* file, const int pageNo);
+    void unlockPartition(const File* file, const int pageNo);
 	
     // insert entry into hash table mapping (file,pageNo) to frameNo;
     // returns 0 if OK, HASHTBLERROR if an error occurred
@@ -42,11 +71,38 @@ public:
 };
 
 
+// readahead: once PREFETCH_TRIGGER consecutive pages of a file have been
+// read, the following PREFETCH_PAGES pages are read in the background.
+const int PREFETCH_TRIGGER = 2;
+const int PREFETCH_PAGES = 8;
+const int PREFETCH_QUEUE = 16;  // max. number of queued prefetch requests
+const int PREFETCH_BATCH = 4;   // max. number of requests read at once
+
+// background writer: every FLUSH_INTERVAL milliseconds it tries to keep
+// numBufs / CLEAN_FRACTION of the frames unpinned and clean.  allocBuf
+// hands dirty victims to it instead of writing them, as long as fewer
+// than FLUSH_BATCH are waiting; each round writes at most 2*FLUSH_BATCH
+// pages.
+const int CLEAN_FRACTION = 4;
+const int FLUSH_BATCH = 32;
+const int FLUSH_INTERVAL = 20;
+
+// default number of frames in the ring of a bulk scan or writer; a
+// ring gets at most 1/RINGSHARE of the pool
+const int RINGSIZE = 16;
+const int RINGSHARE = 8;
+
 class BufMgr;  //forward declaration of BufMgr class 
+class BufReplacer;  // replacement policy, see replacer.h
 
-// class for maintaining information about buffer pool frames
+// class for maintaining information about buffer pool frames.
+// latch protects the descriptor fields below; ioLatch is held by the
+// thread that is reading the page into the frame, so that other threads
+// that find the page in the hash table can wait for the read to finish.
+// Latching order is: hash table partition, then replacer, then frame latch.
 class BufDesc {
     friend class BufMgr;
+    friend class BufReplacer;
 private:
   File* file;   // pointer to file object
   int   pageNo; // page within file
@@ -54,7 +110,9 @@ private:
   int   pinCnt; // number of times this page has been pinned
   bool 	dirty;	  // true if dirty;  false otherwise
   bool 	valid;   // true if page is valid
-  bool  refbit;	 // has this buffer frame been reference recently
+  unsigned int ring;  // id of the ring the page was read by, 0 if none
+  pthread_mutex_t latch;   // protects the fields above
+  pthread_mutex_t ioLatch; // held while the page is being read in
 
   void Clear() {  // initialize buffer frame for a new user
     	pinCnt = 0;
@@ -62,6 +120,7 @@ private:
 	pageNo = -1;
     	dirty = false;
 	valid = false;
+	ring = 0;
   };
 
   void Set(File* filePtr, int pageNum) { 
@@ -70,24 +129,62 @@ private:
       pinCnt = 1;
       dirty = false;
       valid = true;
-      refbit = true;
+      ring = 0;
   }
 
   BufDesc() {
       Clear();
+      pthread_mutex_init(&latch, NULL);
+      pthread_mutex_init(&ioLatch, NULL);
+  }
+
+  ~BufDesc() {
+      pthread_mutex_destroy(&latch);
+      pthread_mutex_destroy(&ioLatch);
   }
 };
 
 
+// A buffer ring gives a bulk operation (a scan of a whole relation or
+// a writer filling a temporary file) a small set of frames that it
+// recycles, instead of taking frames from the whole pool.  Pages read
+// through a ring are not reported to the replacement policy, so they do
+// not push the working set of other queries out of the pool.  A page of
+// a ring that is read by someone without a ring becomes a normal page.
+class BufRing {
+    friend class BufMgr;
+private:
+  unsigned int id;    // marks the frames of the ring in BufDesc::ring
+  int	size;	      // max. number of frames
+  int	count;	      // number of frames in the ring so far
+  int	next;	      // slot to recycle next, once the ring is full
+  int*	frames;	      // frames of the ring
+  pthread_mutex_t latch; // protects the fields above
+
+  BufRing(const unsigned int id, const int size);
+  ~BufRing();
+};
+
+
+// buffer pool statistics.  The counters are updated with atomic adds
+// because several threads may be using the pool at once.
 struct BufStats
 {
   int accesses;    // Total number of accesses to buffer pool
+  int hits;        // Number of accesses that found the page in the pool
   int diskreads;   // Number of pages read from disk (including allocs)
   int diskwrites;  // Number of pages written back to disk
+  int prefetches;  // Number of pages read ahead (included in diskreads)
+  int syncwrites;  // Number of evictions that had to write the victim
 
   void clear()
     {
-      accesses = diskreads = diskwrites = 0;
+      accesses = hits = diskreads = diskwrites = prefetches = syncwrites = 0;
+    }
+
+  double hitRatio() const  // fraction of accesses that were hits
+    {
+      return accesses == 0 ? 0.0 : (double)hits / accesses;
     }
       
   BufStats()
@@ -97,36 +194,166 @@ struct BufStats
 };
 
 
+// The buffer manager may be shared by several threads.  Every public
+// method can be called concurrently; a page returned by readPage or
+// allocPage stays in its frame until the caller unpins it.
+
 class BufMgr 
 {
 private:
-  unsigned int 	 clockHand;
   int   	 numBufs;    	// Number of pages in buffer pool
   BufHashTbl*    hashTable;  	// hash table mapping (File, page) to frame
   BufDesc*	 bufTable;  	// vector of status info, 1 per page
   BufStats	 bufStats;	// buffer pool statistics
+  BufReplacer*	 replacer;	// chooses the frames to reuse
 
-  const Status allocBuf(int & frame);   // allocate a free frame.  
+  // allocate a free frame.  The frame is returned pinned, invalid and
+  // no longer in the hash table.
+  const Status allocBuf(int & frame);
   const void releaseBuf(int frame); // return unused frame to end of list
-  void advanceClock()
+
+  // get a frame for a page that is not in the pool and enter it in the
+  // hash table.  The frame is returned pinned, with ioLatch held until
+  // the caller has read the page in.  present is set, and no frame
+  // taken, if the page turns out to be in the pool already.
+  const Status reserveBuf(File* file, const int pageNo, BufRing* ring,
+			  int & frame, bool & present);
+
+  // finish a hit on a frame pinned by the caller: wait for a read in
+  // progress and tell the replacement policy.  Returns false, with the
+  // frame unpinned, if the read failed.
+  const bool hitBuf(const int frame, File* file, const int pageNo,
+		    BufRing* ring);
+
+  // readahead.  readPage notes which pages are read; sequential runs
+  // queue a request that a background thread carries out.  Prefetched
+  // pages are left unpinned in the pool.
+  struct PrefetchReq
   {
-	clockHand = (clockHand + 1) % numBufs;
-  }
+    File*	file;
+    int		firstPage;
+    int		numPages;
+    BufRing*	ring;     // ring of the reader, or NULL
+  };
+
+  deque<PrefetchReq> pfQueue;	// requests not yet started
+  PrefetchReq	 pfActive[PREFETCH_BATCH]; // requests being read
+  int		 pfNumActive;	// # of entries in pfActive
+  bool		 pfStop;	// set to shut the prefetcher down
+  pthread_mutex_t pfLatch;	// protects the fields above
+  pthread_cond_t  pfWork;	// signalled when a request is queued
+  pthread_cond_t  pfDone;	// signalled when a request is finished
+  pthread_t	 prefetcher;
+
+  void noteRead(File* file, const int pageNo, BufRing* ring);
+  void prefetch(const PrefetchReq & req, IOQueue* queue);
+  // read a run of pages into frames from reserveBuf.  The frames are
+  // unpinned afterwards unless pin is set and all pages were read.
+  const Status readRun(File* file, const int firstPage, const int count,
+		       const int* frames, BufRing* ring, const bool pin);
+  // the second half of readRun, for a read done through an IOQueue
+  const Status finishRun(IORequest* io, const int* frames, BufRing* ring,
+			 const bool pin);
+  // drop and wait for the requests for file (or for ring, if file
+  // is NULL)
+  void cancelPrefetch(const File* file, const BufRing* ring = NULL);
+  static void* prefetchMain(void* arg);
+
+  // every thread that calls readPages gets its own queue
+  pthread_key_t	 ioKey;
+  IOQueue*	 threadQueue();
+
+  // rings
+  unsigned int	 ringIds;	// last ring id handed out
+
+  // get a frame from ring; returned like allocBuf does
+  const Status ringBuf(BufRing* ring, int & frame);
+  // write out the dirty unpinned pages of ring, and the one in the
+  // frame the caller is about to recycle
+  void flushRing(BufRing* ring, const int frame);
+
+  // write out the page in a pinned frame if it is dirty, and remove
+  // it from the hash table.  evicted is false, and the frame unpinned,
+  // if another thread pinned or updated the page meanwhile.
+  const Status evictBuf(const int frame, bool & evicted);
+
+  // background writer.  It pins the frames it writes, so flushFile
+  // and disposePage hold bgLatch and call writeBehind themselves to
+  // make sure it has no frames pinned while they work.
+  unsigned int	 flushHand;	// next frame the writer looks at
+  int		 flushQueue[FLUSH_BATCH]; // pinned dirty victims
+  int		 flushQueued;	// # of frames in flushQueue
+  int		 flushPinned;	// # of frames the writer has pinned
+  unsigned int	 flushGen;	// incremented when frames are unpinned
+  bool		 flushStop;	// set to shut the writer down
+  pthread_mutex_t flushLatch;	// protects the fields above
+  pthread_cond_t  flushWork;	// signalled when a victim is queued
+  pthread_cond_t  flushDone;	// signalled when frames are unpinned
+  pthread_mutex_t bgLatch;	// held while the writer pins pages
+  pthread_t	 flusher;
+
+  struct FlushEntry
+  {
+    File*	file;
+    int		pageNo;
+    int		frameNo;
+
+    bool operator < (const FlushEntry & other) const
+    {
+      return file < other.file ||
+	(file == other.file && pageNo < other.pageNo);
+    }
+  };
+
+  // write the pages of pinned frames that the caller has marked clean.
+  // Consecutive pages of a file are written with a single call; pages
+  // that could not be written are marked dirty again.  The frames stay
+  // pinned.  Returns the first error.
+  const Status writeFrames(FlushEntry* batch, const int count);
+  void writeBehind(const bool clean); // write queued victims and more
+  static void* flushMain(void* arg);
 
 
 public:
-  Page*	         bufPool;   // actual buffer pool
+  char*	         bufPool;   // actual buffer pool, PAGESIZE bytes per frame
+
+  Page* framePage(const int frame) const  // the page held by frame
+  {
+	return (Page*)(bufPool + (size_t)frame * PAGESIZE);
+  }
 
-  BufMgr(const int bufs);
+  // policy names the replacement policy: "clock", "2q" or "lru2".
+  // An unknown name selects clock.
+  BufMgr(const int bufs, const string & policy = "clock");
   ~BufMgr();
 
-  const Status readPage(File* file, const int PageNo, Page*& page);
+  // ring is the buffer ring of a bulk operation, see createRing
+  const Status readPage(File* file, const int PageNo, Page*& page,
+			BufRing* ring = NULL);
+  // pin count pages of file at once.  The pages that are not in the
+  // pool are read with one call per run of consecutive page numbers.
+  // On error, none of the pages is left pinned.
+  const Status readPages(File* file, const int* pageNos, const int count,
+			 Page** pages, BufRing* ring = NULL);
   const Status unPinPage(File* file, const int PageNo, const bool dirty);
-  const Status allocPage(File* file, int& PageNo, Page*& page); 
+  const Status allocPage(File* file, int& PageNo, Page*& page,
+			 BufRing* ring = NULL); 
                         // allocates a new, empty page 
+
+  BufRing* createRing(const int size = RINGSIZE); // ring for a bulk operation
+  void releaseRing(BufRing* ring);  // done with the ring, deletes it
   const Status flushFile(const File* file); // writing out all dirty pages of the file
   const Status disposePage(File* file, const int PageNo); // dispose of page in file
   void  printSelf();
+  void  printStats();   // print hit ratio and I/O counts of the pool
+  const char* policyName() const; // name of the replacement policy
+
+  const int getNumBufs() const // number of frames in the pool
+  {
+	return numBufs;
+  }
+
+  const int getNumUnpinned(); // number of frames nobody has pinned now
 
   const BufStats & getBufStats() const // get buffer pool usage
   {
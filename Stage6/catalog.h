@@ -70,14 +70,18 @@ class RelCatalog : public HeapFile {
 //   attribute number : integer(4)
 //   attribute type : integer(4)  (type is Datatype actually)
 //   attribute size : integer(4)
+//   index kind : integer(4)  (an IndexKind)
 
 
+enum IndexKind { INDEX_NONE, INDEX_BTREE, INDEX_HASH };  // kinds of index
+
 typedef struct {
   char relName[MAXNAME];                // relation name
   char attrName[MAXNAME];               // attribute name
   int attrOffset;                       // attribute offset
   int attrType;                         // attribute type
   int attrLen;                          // attribute length
+  int indexed;                          // kind of index on attribute
 } AttrDesc;
 
 
@@ -104,6 +108,11 @@ class AttrCatalog : public HeapFile {
 			  int &attrCnt, 
 			  AttrDesc *&attrs);
 
+  // record the kind of index an attribute has
+  const Status setIndexed(const string & relation,
+			  const string & attrName,
+			  const IndexKind kind);
+
   // delete all information about a relation
   const Status dropRelation(const string & relation);
 
@@ -2,6 +2,7 @@
 #define DB_H
 
 #include <sys/types.h>
+#include <pthread.h>
 #include <functional>
 #include "error.h"
 #include <string.h>
@@ -15,10 +16,24 @@ using namespace std;
 // forward class definition for db
 class DB;
 
+// structure of DB (header) page
+
+struct DBPage {
+  int nextFree;                         // page # of next page on free list
+  int firstPage;                        // page # of first page in file
+  int numPages;                         // total # of pages in file
+  int pageSize;                         // page size of the file in bytes
+};
+
+// files grow by this many pages at a time
+const int EXTENTSIZE = 32;
+
 // class definition for open files
 class File {
   friend class DB;
   friend class OpenFileHashTbl;
+  friend class BufMgr;
+  friend class IOQueue;
 
  public:
 
@@ -28,6 +43,12 @@ class File {
 		  Page* pagePtr) const;       // read page from file
   const Status writePage(const int pageNo,
 		   const Page* pagePtr);      // write page to file
+  const Status readPages(const int firstPage, const int count,
+		  Page** pages, int& numRead) const;
+			// read consecutive pages with a single call
+  const Status writePages(const int firstPage, const int count,
+		   Page** pages);
+			// write consecutive pages with a single call
   const Status getFirstPage(int& pageNo) const;     // returns pageNo of first page
 
   bool operator == (const File & other) const
@@ -50,6 +71,10 @@ class File {
 		 Page* pagePtr) const;        // internal file read
   const Status intwrite(const int pageNo,
 		  const Page* pagePtr);       // internal file write
+  const Status intreadHdr(const int pageNo,
+		 DBPage& header) const;       // read DB header fields of page
+  const Status intwriteHdr(const int pageNo,
+		  const DBPage& header);      // write DB header fields of page
 
 #ifdef DEBUGFREE
   void listFree();                      // list free pages
@@ -58,6 +83,19 @@ class File {
   string fileName;                    // The name of the file
   int openCnt;                        // # times file has been opened
   int unixFile;                       // unix file stream for file
+
+  // The header page is kept in memory while the file is open and
+  // written back when it is closed.
+  DBPage hdr;                         // the header fields
+  bool hdrDirty;                      // hdr differs from the disk copy
+  int extentEnd;                      // # of pages the file has room for
+  mutable pthread_mutex_t hdrLatch;   // protects the fields above
+
+  // sequential access detection, maintained by BufMgr::readPage
+  pthread_mutex_t raLatch;            // protects the fields below
+  int raLast;                         // last page read
+  int raRun;                          // # of consecutive pages read so far
+  int raNext;                         // first page not yet prefetched
 };
 
 class BufMgr;
@@ -109,17 +147,13 @@ class DB {
   const Status openFile(const string & fileName, File* & file);  // open a file
   const Status closeFile(File* file);         // close a file
 
+  // page size the file was created with
+  const Status getPageSize(const string & fileName, int & pageSize) const;
+
  private:
   OpenFileHashTbl   openFiles;    // list of open files
+  pthread_mutex_t   latch;        // protects openFiles and open counts
 };
 
 
-// structure of DB (header) page
-
-typedef struct {
-  int nextFree;                         // page # of next page on free list
-  int firstPage;                        // page # of first page in file
-  int numPages;                         // total # of pages in file
-} DBPage;
-
 #endif
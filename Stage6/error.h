@@ -17,7 +17,7 @@ enum Status {
 // File and DB errors
 
        BADFILEPTR, BADFILE, FILETABFULL, FILEOPEN, FILENOTOPEN,
-       UNIXERR, BADPAGEPTR, BADPAGENO, FILEEXISTS,
+       UNIXERR, BADPAGEPTR, BADPAGENO, FILEEXISTS, BADPAGESIZE,
 
 // BufMgr and HashTable errors
 
@@ -0,0 +1,37 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include "heapfile.h"
+
+// Selection kernels.
+//
+// A filtered scan on an INTEGER or FLOAT attribute gathers the
+// attribute of all records of a page (Page::gatherAttr) and compares
+// them with the filter in one go.  Each kernel sets bit i of bits[]
+// if values[i] op value holds, for i < count, and clears the other
+// bits of the last word.  On x86 the comparisons are done eight at a
+// time with AVX2 or four at a time with SSE2, depending on what the
+// processor supports; elsewhere one at a time.
+
+// a op b, with op known at compile time
+template <Operator OP, class T>
+static inline bool compare(const T a, const T b)
+{
+    switch (OP) {
+    case LT:  return a < b;
+    case LTE: return a <= b;
+    case EQ:  return a == b;
+    case GTE: return a >= b;
+    case GT:  return a > b;
+    case NE:  return a != b;
+    }
+    return false;
+}
+
+void filterInts(const int values[], const int count, const Operator op,
+		const int value, unsigned bits[]);
+
+void filterFloats(const int values[], const int count, const Operator op,
+		  const float value, unsigned bits[]);
+
+#endif
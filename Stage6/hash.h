@@ -0,0 +1,130 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include "index.h"
+
+// Extendible hash index.
+//
+// A HashIndex finds the entries with a given key in one bucket, so an
+// equality lookup costs a directory page and a bucket page, however
+// large the index gets.  The directory has 2^depth entries, each the
+// page number of a bucket; a key goes to the bucket of the entry
+// given by the low depth bits of its hash value.  A bucket that is
+// full is split in two by one more bit of the hash values, and the
+// directory doubles when the bucket is already told apart by all of
+// its bits.  Entries that cannot be told apart, because they all have
+// the same hash value, or because the directory has reached its
+// maximum size, go on overflow pages chained to the bucket; a lookup
+// of such a key reads the whole chain.  The chain keeps the order the
+// entries came in, so removing them in that order, as a delete does
+// after a load, finds them near its front; overflow pages that empty
+// are unchained.  Buckets are not merged when they empty.
+
+// header page of an index file
+struct HashHdr
+{
+    int		attrType;	// type of the key
+    int		attrLen;	// length of the key in bytes
+    int		depth;		// global depth
+    int		dirCnt;		// # of directory pages
+    int		dirPages[1];	// the directory pages
+};
+
+// a bucket page.  An entry is the key followed by a RID.
+struct HashBucket
+{
+    int		depth;		// local depth; # of bits its keys share
+    int		count;		// # of entries on the page
+    int		next;		// next overflow page, -1 for none
+    int		last;		// of the first page: last page of the chain
+    char	entries[1];
+};
+
+const int HASHHDRFIXED = 4 * sizeof(int);	// bytes of the header before
+						// the directory pages
+const int HASHFIXED = 4 * sizeof(int);		// bytes of a bucket before
+						// the entries
+
+
+// create an index file for keys of type and length, with numBuckets
+// buckets to start with (rounded up to a power of 2).  Returns
+// BADINDEXPARM if a page cannot hold two entries or the directory
+// would be too large.
+extern const Status createHashIndex(const string & fileName,
+				    const Datatype type, const int length,
+				    const int numBuckets);
+
+// destroy an index file
+extern const Status destroyHashIndex(const string & fileName);
+
+
+class HashIndex : public AttrIndex
+{
+public:
+    // open the index in file fileName
+    HashIndex(const string & fileName, Status & status);
+
+    // ends a scan that is going on and closes the file
+    ~HashIndex();
+
+    const Status insertEntry(const void* key, const RID & rid);
+    const Status deleteEntry(const void* key, const RID & rid);
+
+    // only EQ can be scanned for
+    const Status startScan(const void* value, const Operator op);
+    const Status scanNext(RID & outRid);
+    const Status endScan();
+
+private:
+    File*	file;
+    int		hdrPageNo;
+    HashHdr*	hdr;		// pinned header page
+    bool	hdrDirty;
+
+    int		entrySize;	// bytes of an entry
+    int		capacity;	// max. # of entries of a bucket page
+    int		perDirPage;	// # of directory entries of a page
+    int		maxDirPages;	// # of directory pages the header can hold
+
+    // the scan
+    vector<char> scanKey;	// the value, as long as a key
+    HashBucket*	scanPage;	// pinned page of the bucket, NULL if none
+    int		scanPageNo;
+    int		scanPos;	// next entry of scanPage
+
+    char* entry(HashBucket* bucket, const int i) const
+	{ return bucket->entries + i * entrySize; }
+
+    // hash value of a key
+    unsigned hash(const char* key) const;
+
+    // true if keys a and b are equal
+    bool equal(const char* a, const char* b) const;
+
+    // read or set directory entry i
+    const Status getDir(const int i, int & bucketNo);
+    const Status setDir(const int i, const int bucketNo);
+
+    // put an entry in bucket bucketNo, on its first page or the last
+    // page of its chain.  If neither has room, returns BUCKETFULL, or
+    // with chain set puts it on a new overflow page at the end of the
+    // chain.
+    const Status addEntry(const int bucketNo, const char* key,
+			  const RID & rid, const bool chain);
+
+    // take the empty overflow page pageNo, which follows prevNo and
+    // comes before nextNo, out of the chain of bucket bucketNo
+    const Status unchain(const int bucketNo, const int prevNo,
+			 const int pageNo, const int nextNo);
+
+    // split bucket bucketNo, whose entries have hash values with low
+    // bits hashBits, doubling the directory if needed.  Returns
+    // DIROVERFLOW if the directory cannot grow.
+    const Status split(const int bucketNo, const unsigned hashBits);
+
+    // same is true if all entries on the first page of bucket bucketNo
+    // have hash value h; splitting the bucket would not help then
+    const Status sameHash(const int bucketNo, const unsigned h, bool & same);
+};
+
+#endif
@@ -20,9 +20,34 @@ extern DB db;
 
 // Some constant definitions
 const unsigned MAXNAMESIZE = 50;
+const int FSMDIRSIZE = 32;	// max. # of free-space map pages
+const int PAGEDIRSIZE = 128;	// max. # of page directory pages
+const int ZONEATTRS = 4;	// max. # of attributes with a zone map
+const int FILEPINS = 3 + ZONEATTRS; // max. # of pages an open file keeps
+				// pinned: header, data, map and zone pages
+const int VACUUMBATCH = 64;	// # of pages vacuumed between pauses
+const int SCANBATCH = 256;	// # of records in a scan batch
+const int BATCHPAGES = 4;	// max. # of pages a scan batch spans
+const int INSERTBATCH = 256;	// # of records in an insert batch
 
 enum Datatype { STRING, INTEGER, FLOAT };    // attribute data types
 enum Operator { LT, LTE, EQ, GTE, GT, NE };  // scan operators
+enum CondKind { COND_CMP, COND_AND, COND_OR, COND_NOT };  // scan conditions
+
+// a condition of a filtered scan: a comparison of an attribute with a
+// value, given as for HeapFileScan::startScan, or the AND or OR of left
+// and right, or NOT left
+struct ScanCond
+{
+  CondKind	kind;
+  int		offset;		// COND_CMP
+  int		length;
+  Datatype	type;
+  Operator	op;
+  const char*	filter;
+  ScanCond*	left;		// the operands otherwise
+  ScanCond*	right;
+};
 
 struct FileHdrPage
 {
@@ -31,6 +56,41 @@ struct FileHdrPage
   int		lastPage;	// pageNo of last data page in file
   int		pageCnt;	// number of pages
   int		recCnt;		// record count
+
+  // free-space map.  Map page i has a byte for each of the pages
+  // i * PAGESIZE .. (i+1) * PAGESIZE - 1 of the file, see
+  // HeapFile::setFreeSpace.
+  int		fsmPages[FSMDIRSIZE];	// pageNo of map page, 0 if none yet
+  unsigned char	fsmMax[FSMDIRSIZE];	// no entry of map page is larger
+
+  // page directory: the data pages in the order of the chain, so that
+  // they can be divided among scans without reading them, see
+  // HeapFile::getPageDir.
+  int		dirPages[PAGEDIRSIZE];	// pageNo of directory page, 0 if none
+  int		dirCnt;		// # of entries, <= 0 if there is no directory
+
+  // zone maps, see HeapFile::addZoneMap
+  int		zoneCnt;		// # of attributes with a zone map
+  int		zoneOffsets[ZONEATTRS];	// offset of the attribute
+  int		zoneTypes[ZONEATTRS];	// its Datatype
+  int		zoneRoots[ZONEATTRS];	// pageNo of root page, 0 if none yet
+};
+
+// a zone map entry: the range of an attribute over the records of a
+// data page
+struct ZoneEntry
+{
+  int		count;		// # of records with the attribute
+  int		lo;		// smallest value, an int or a float
+  int		hi;		// largest value
+};
+
+
+// a record returned by HeapFileScan::scanNextBatch
+struct ScanRec
+{
+  RID		rid;
+  Record	rec;		// points into the pinned page
 };
 
 
@@ -46,11 +106,58 @@ protected:
    int   	curPageNo;	// page number of pinned page
    bool  	curDirtyFlag;   // true if page has been updated
    RID   	curRec;         // rid of last record returned
+   BufRing*	ring;		// buffer ring for bulk access, or NULL
+
+   Page*	fsmPage;	// free-space map page pinned, or NULL
+   int		fsmPageNo;	// page number of pinned map page
+   bool		fsmDirty;	// true if map page has been updated
+
+   // pin the map page with the entry for pageNo and return the entry.
+   // If create is true, a missing map page is allocated; otherwise
+   // entry is NULL.  entry is also NULL if the page is beyond the map.
+   const Status pinFsm(const int pageNo, const bool create,
+		       unsigned char*& entry);
+
+   // record the free space on page in the free-space map
+   const Status setFreeSpace(const int pageNo, const Page* page);
+
+   // find a data page with room for a record of length bytes;
+   // pageNo is -1 if there is none
+   const Status findFreePage(const int length, int& pageNo);
+
+   // append pageNo, a new last page, to the page directory
+   const Status addToDir(const int pageNo);
+
+   // mark the entry of pageNo in the page directory as given back
+   const Status removeFromDir(const int pageNo);
+
+   Page*	zonePages[ZONEATTRS];	// zone map page pinned, or NULL
+   int		zonePageNos[ZONEATTRS];	// page number of pinned map page
+   int		zoneKeys[ZONEATTRS];	// # of the map page in the root
+   bool		zoneDirty[ZONEATTRS];	// true if map page has been updated
+
+   // the zone map of the attribute at offset, -1 if none
+   const int findZone(const int offset, const Datatype type) const;
+
+   // pin the zone map page with the entry for pageNo in zone map zone
+   // and return the entry.  If create is true, missing pages are
+   // allocated; otherwise entry is NULL.  entry is also NULL if the
+   // page is beyond the map.
+   const Status pinZone(const int zone, const int pageNo, const bool create,
+			ZoneEntry*& entry);
+
+   // account for rec being added to or removed from page pageNo in
+   // the zone maps
+   const Status zoneInsert(const int pageNo, const Record & rec);
+   const Status zoneDelete(const int pageNo, const Record & rec);
 
 public:
 
-  // initialize
-  HeapFile(const string & name, Status& returnStatus);
+  // initialize.  If bulk is true, data pages are read and allocated
+  // through a small buffer ring of their own (see BufMgr::createRing),
+  // so that a scan of the whole file leaves the rest of the pool alone.
+  HeapFile(const string & name, Status& returnStatus,
+	   const bool bulk = false);
 
   // destructor
   ~HeapFile();
@@ -60,6 +167,27 @@ public:
 
   // given a RID, read record from file, returning pointer and length
   const Status getRecord(const RID &rid, Record & rec);
+
+  // compact up to maxPages data pages, starting with page pageNo (-1
+  // for the first data page).  Records of a page that fit on the page
+  // before it are moved there, and empty pages are unlinked and given
+  // back to the file.  Moved records get new RIDs.  pageNo returns the
+  // page to continue with, or -1 when the end of the file is reached;
+  // freed returns the number of pages given back.  No page is left
+  // pinned between calls.
+  const Status vacuum(int& pageNo, const int maxPages, int& freed);
+
+  // return the data pages of the file in the order of the chain.
+  // Returns FILEHDRFULL if the file has outgrown its page directory
+  // or was created without one.
+  const Status getPageDir(vector<int>& pages);
+
+  // keep a zone map of the INTEGER or FLOAT attribute at offset: for
+  // each data page, the smallest and largest value of the attribute on
+  // the page.  A filtered scan passes over the pages the map shows
+  // cannot match, without reading them.  Must be called while the file
+  // is empty; returns FILEHDRFULL after ZONEATTRS attributes.
+  const Status addZoneMap(const int offset, const Datatype type);
 };
 
 
@@ -67,7 +195,8 @@ class HeapFileScan : public HeapFile
 {
 public:
 
-    HeapFileScan(const string & name, Status & status);
+    HeapFileScan(const string & name, Status & status,
+		 const bool bulk = false);
 
     // end filtered scan
     ~HeapFileScan();
@@ -78,6 +207,16 @@ public:
                            const char* filter, 
                            const Operator op);
 
+    // filter on a condition tree instead of a single comparison.  The
+    // values the comparisons point to must stay around until the
+    // scan ends, the tree itself need not.
+    const Status startScan(const ScanCond* cond);
+
+    // scan only the pages pageNos[0..count-1], in that order, instead
+    // of following the chain of data pages; see getPageDir.  The
+    // array must stay around until the scan ends.
+    const Status scanPages(const int* pageNos, const int count);
+
     const Status endScan(); // terminate the scan
     const Status markScan(); // save current position of scan
     const Status resetScan(); // reset scan to last marked location
@@ -88,6 +227,22 @@ public:
     // read current record, returning pointer and length
     const Status getRecord(Record & rec);
 
+    // return up to maxRecs of the next records that satisfy the scan
+    // in recs.  The records may come from up to maxPages pages, which
+    // stay pinned until releaseBatch() or the next call of
+    // scanNextBatch(); the last of them is the current record of the
+    // scan.  Returns FILEEOF if there are no more records.
+    const Status scanNextBatch(ScanRec recs[], const int maxRecs,
+			       int& numRecs, const int maxPages = BATCHPAGES);
+
+    // unpin the pages of the last batch, except the current page
+    const Status releaseBatch();
+
+    // delete a record of the last batch.  Records of the same page
+    // that follow it in the page move, so their Record pointers are
+    // no longer valid.
+    const Status deleteRecord(const RID & rid);
+
     // delete current record 
     const Status deleteRecord();
 
@@ -101,12 +256,58 @@ private:
     const char* filter;      // comparison value of filter
     Operator op;             // comparison operator of filter
 
+    // compares the filter attribute of a record with the filter; one
+    // for each type and operator, chosen by startScan
+    typedef bool (*AttrMatch)(const char* attr, const char* filter,
+			      const int length);
+    AttrMatch match;
+
+    struct Cond;             // compiled condition tree, see heapfile.C
+    Cond* cond;              // set by startScan(const ScanCond*)
+
      // The following variables are used to preserve the state
     // of the scan when the method markScan() is invoked.
     // A subsequent invocation of resetScan() will cause the
     // scan to be rolled back to the following
     int   markedPageNo;	// page number of pinned page
     RID   markedRec;         // rid of last record returned
+    int   markedListPos;
+
+    // the pages set by scanPages, or NULL to follow the chain.  A scan
+    // with a filter on an attribute with a zone map goes by the page
+    // directory instead, kept in dirList.
+    const int* pageList;
+    int   pageListCnt;
+    int   pageListPos;       // position of the current page in pageList
+    vector<int> dirList;
+
+    // the page the scan goes on with after the current one, -1 at the
+    // end.  pos is the position in pageList; it is advanced to that of
+    // the page returned.  Pages the zone maps rule out are passed over.
+    const int nextScanPage(int& pos);
+
+    // false if the zone maps show that no record of page pageNo
+    // satisfies the filter, or the comparison given
+    bool zoneMatch(const int pageNo);
+    bool zoneMatch(const int pageNo, const int offset, const Datatype type,
+		   const Operator op, const char* filter);
+
+    // go by the page directory if the filter can use the zone maps
+    const Status useZones();
+
+    // pages of the last batch other than the current page
+    vector<Page*> batchPages;
+    vector<int>   batchPageNos;
+    vector<bool>  batchDirty;
+
+    // for INTEGER and FLOAT filters, scanNextBatch evaluates the
+    // filter for all records of a page at once (see filter.h)
+    int*  pageAttrs;         // filter attribute of each slot
+    unsigned* pageBits;      // slots that match the filter
+    unsigned* pageLive;      // slots with a record that has the attribute
+    int   pageSlots;         // # of slots of the page
+
+    void filterPage();
 
     const bool matchRec(const Record & rec) const;
 };
@@ -116,13 +317,26 @@ class InsertFileScan : public HeapFile
 {
 public:
 
-    InsertFileScan(const string & name, Status & status);
+    InsertFileScan(const string & name, Status & status,
+		   const bool bulk = false);
 
     // end filtered scan
     ~InsertFileScan();
 
     // insert record into file, returning its RID
     const Status insertRecord(const Record & rec, RID& outRid); 
+
+    // insert recs[0..count-1], returning their RIDs in outRids unless
+    // it is NULL.  Whatever room the current page has is used first;
+    // the other records are laid out on new pages added at the end of
+    // the file, filling each before the next one is started.
+    const Status insertBatch(const Record recs[], const int count,
+			     RID outRids[]);
+
+private:
+    // add an empty data page at the end of the file and make it the
+    // current page
+    const Status addPage();
 };
 
 #endif
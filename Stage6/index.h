@@ -0,0 +1,82 @@
+#ifndef INDEX_H
+#define INDEX_H
+
+#include "catalog.h"
+
+// Secondary indexes on the attributes of relations.
+//
+// The index on an attribute is kept in a file named after the relation
+// and the attribute; the attribute catalog records which attributes
+// have one and of what kind.  An index maps the values of the
+// attribute to the RIDs of the records holding them.  AttrIndex is
+// what the kinds of index have in common; the functions below hide
+// which kind is used.
+
+class AttrIndex
+{
+public:
+  virtual ~AttrIndex();
+
+  // add an entry for the record rid with key key
+  virtual const Status insertEntry(const void* key, const RID & rid) = 0;
+
+  // remove the entry for the record rid with key key; RECNOTFOUND if
+  // there is none
+  virtual const Status deleteEntry(const void* key, const RID & rid) = 0;
+
+  // start a scan for the entries whose key compares with value as op
+  // says.  Returns BADINDEXPARM if the index cannot be scanned for op.
+  virtual const Status startScan(const void* value, const Operator op) = 0;
+
+  // RID of the next entry of the scan; NOMORERECS at the end
+  virtual const Status scanNext(RID & outRid) = 0;
+
+  virtual const Status endScan() = 0;
+
+  // open the index of attribute attr
+  static AttrIndex* open(const AttrDesc & attr, Status & status);
+};
+
+
+// name of the file of the index on relation.attrName
+const string indexFileName(const string & relation, const string & attrName);
+
+// create an index of kind on attribute attr and fill it with the
+// records of its relation.  numBuckets is the initial number of
+// buckets of a hash index; 0 lets the index size itself.
+const Status buildIndex(const AttrDesc & attr, const IndexKind kind,
+			const int numBuckets);
+
+// build the indexes of a relation anew, after its records have moved
+const Status rebuildIndexes(const string & relation);
+
+// destroy the indexes of a relation
+const Status destroyIndexes(const string & relation);
+
+// the data pages of file holding records whose attribute attr compares
+// with value as op says, in the order a scan of the file visits them.
+// Returns NOINDEX if attr has no index that can be used for op.
+const Status indexPages(HeapFile & file, const AttrDesc & attr,
+			const Operator op, const char* value,
+			vector<int> & pages);
+
+
+// The indexes of a relation, for keeping them up to date as records
+// are added and removed.
+
+class RelIndexes
+{
+public:
+  RelIndexes(const string & relation, Status & status);
+  ~RelIndexes();
+
+  // add the entries of record rec, or remove them
+  const Status insertEntries(const Record & rec, const RID & rid);
+  const Status deleteEntries(const Record & rec, const RID & rid);
+
+private:
+  vector<AttrDesc> attrs;		// the indexed attributes
+  vector<AttrIndex*> indexes;
+};
+
+#endif
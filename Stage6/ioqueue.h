@@ -0,0 +1,85 @@
+#ifndef IOQUEUE_H
+#define IOQUEUE_H
+
+#include <sys/uio.h>
+#include "page.h"
+#include "db.h"
+
+// Asynchronous page I/O.
+//
+// An IOQueue lets a thread start several reads or writes of page runs
+// and pick them up as they complete, so a batch of buffer misses is
+// waited for once instead of one by one.  If the Makefile defines
+// IO_URING, requests are submitted to an io_uring; otherwise, or if the
+// kernel refuses to set one up, submit() carries the request out right
+// away with File::readPages/writePages and wait() just hands it back.
+//
+// A queue belongs to one thread: requests are completed by the thread
+// that waits for them, so locks taken before a read can be released
+// when it is done.
+
+const int IODEPTH = 32;	// max. # of requests in flight per queue
+
+struct IORequest
+{
+  File*		file;
+  int		firstPage;	// first page of the run
+  int		count;		// # of pages
+  Page**	pages;		// where the pages are read from or to
+  bool		write;		// write instead of read
+  void*		arg;		// for use by the submitter
+
+  // set on completion
+  Status	status;
+  int		numDone;	// # of pages read or written
+
+  struct iovec*	iov;		// used by IOQueue
+  IORequest*	next;
+};
+
+
+class IOQueue
+{
+public:
+  IOQueue(const int depth = IODEPTH);
+  ~IOQueue();
+
+  // start req.  The request and its pages must stay around until
+  // wait() returns it.
+  const Status submit(IORequest* req);
+
+  // next completed request, waiting if necessary; NULL if no request
+  // is outstanding
+  IORequest* wait();
+
+  bool async() const;	// true if the requests go to an io_uring
+
+private:
+  int		depth;		// max. # of requests in flight
+  int		inFlight;	// # of requests submitted, not yet reaped
+  IORequest*	doneHead;	// completed requests not yet returned
+  IORequest*	doneTail;
+
+  void complete(IORequest* req, const int result);
+  void reap(const bool block);	// move completions to the done list
+
+#ifdef IO_URING
+  int		ringFd;		// -1 if no io_uring could be set up
+  void*		sqRing;		// mapped submission queue ring
+  void*		cqRing;		// mapped completion queue ring
+  size_t	sqSize;
+  size_t	cqSize;
+  struct io_uring_sqe* sqes;	// mapped submission queue entries
+  size_t	sqesSize;
+  unsigned*	sqHead;
+  unsigned*	sqTail;
+  unsigned*	sqMask;
+  unsigned*	sqArray;
+  unsigned*	cqHead;
+  unsigned*	cqTail;
+  unsigned*	cqMask;
+  struct io_uring_cqe* cqes;
+#endif
+};
+
+#endif
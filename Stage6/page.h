@@ -18,14 +18,21 @@ struct Record
 
 // slot structure
 struct slot_t {
-        short	offset;  
-        short	length;  // equals -1 if slot is not in use
+        int	offset;  
+        int	length;  // equals -1 if slot is not in use
 };
 
-const unsigned PAGESIZE = 1024;
-const unsigned DPFIXED= sizeof(slot_t)+4*sizeof(short)+2*sizeof(int);
-const unsigned PAGEDATASIZE = PAGESIZE-DPFIXED+sizeof(slot_t);
-// size of the data area of a page
+// Page size of the database, in bytes.  It is chosen when the database
+// is created (see dbcreate) and recorded in the header page of every
+// file; minirel sets it from the catalog before the buffer manager is
+// created.  It must be a power of 2 between MINPAGESIZE and MAXPAGESIZE.
+extern unsigned PAGESIZE;
+const unsigned DEFAULTPAGESIZE = 1024;
+const unsigned MINPAGESIZE = 1024;
+const unsigned MAXPAGESIZE = 65536;
+
+const unsigned DPFIXED= sizeof(slot_t)+6*sizeof(int);
+// fixed part of a data page: the page header and the first slot
 
 // Class definition for a minirel data page.   
 // The design assumes that records are kept compacted when
@@ -33,17 +40,28 @@ const unsigned PAGEDATASIZE = PAGESIZE-DPFIXED+sizeof(slot_t);
 // array cannot be compacted.  Notice, this class does not keep
 // the records align, relying instead on upper levels to take
 // care of non-aligned attributes
+//
+// A page is PAGESIZE bytes long, so the class only describes its
+// beginning: the header is followed by the data area, and the slot
+// array grows backwards from the end of the page.  Pages therefore
+// cannot be declared as variables; they live in the buffer pool.
 
 class Page {
 private:
-    char 	data[PAGESIZE - DPFIXED]; 
-    slot_t 	slot[1]; // first element of slot array - grows backwards!
-    short	slotCnt; // number of slots in use;
-    short	freePtr; // offset of first free byte in data[]
-    short	freeSpace; // number of bytes free in data[]
-    short	dummy;	// for alignment purposes
     int		nextPage; // forwards pointer
     int		curPage;  // page number of current pointer
+    int		slotCnt; // number of slots in use;
+    int		freePtr; // offset of first free byte in data[]
+    int		freeSpace; // number of bytes free in data[]
+    int		dummy;	// for alignment purposes
+    char 	data[1];  // data area, PAGESIZE - DPFIXED bytes
+
+    // the slot array. Slot 0 is the last slot_t of the page, slot -1
+    // the one before it, and so on.
+    slot_t* slotArray() const
+    {
+	return (slot_t*)((char*)this + PAGESIZE) - 1;
+    }
 
 public:
     void init(const int pageNo); // initialize a new page
@@ -51,11 +69,17 @@ public:
 
     const Status getNextPage(int& pageNo) const; // returns value of nextPage
     const Status setNextPage(const int pageNo); // sets value of nextPage to pageNo
-    const short getFreeSpace() const; // returns amount of free space
+    const int getFreeSpace() const; // returns amount of free space
 
     // inserts a new record (rec) into the page, returns RID of record 
     const Status insertRecord(const Record & rec, RID& rid);
 
+    // append records from recs[0..count-1] to the page in new slots,
+    // in order, until one does not fit.  Returns the number appended;
+    // their RIDs are put in rids unless it is NULL.
+    const int appendRecords(const Record recs[], const int count,
+			    RID rids[]);
+
     // delete the record with the specified rid
     const Status deleteRecord(const RID & rid);
 
@@ -69,6 +93,11 @@ public:
 
     // returns reference to record with RID rid
     const Status getRecord(const RID & rid, Record & rec);
+
+    // copy the 4-byte attribute at offset of every slot into attrs[]
+    // and set bit i of live[] if slot i holds a record long enough to
+    // have it.  Returns the number of slots.
+    const int gatherAttr(const int offset, int attrs[], unsigned live[]) const;
 };
 
 #endif
@@ -56,8 +56,10 @@ typedef enum {
     N_DROP,
     N_LOAD,
     N_PRINT,
+    N_VACUUM,
     N_HELP,
     N_SELECT,
+    N_COND,
     N_JOIN,
     N_PRIMATTR,
     N_QUALATTR,
@@ -132,6 +134,11 @@ typedef struct node {
 	    char *relname;
 	} PRINT;
 
+	// vacuum node */
+	struct {
+	    char *relname;
+	} VACUUM;
+
 	// help node */
 	struct {
 	    char *relname;
@@ -144,6 +151,13 @@ typedef struct node {
 	    struct node *value;
 	} SELECT;
 
+	// condition node: AND or OR of left and right, or NOT left */
+	struct {
+	    int op;			// RW_AND, RW_OR or RW_NOT
+	    struct node *left;
+	    struct node *right;
+	} COND;
+
 	// join node */
 	struct {
 	    struct node *joinattr1;
@@ -222,8 +236,10 @@ NODE *rebuild_node(char *relname, char *attrname, int nbuckets);
 NODE *drop_node(char *relname, char *attrname);
 NODE *load_node(char *relname, char *filename);
 NODE *print_node(char *relname);
+NODE *vacuum_node(char *relname);
 NODE *help_node(char *relname);
 NODE *select_node(NODE *selattr, int op, NODE *value);
+NODE *cond_node(int op, NODE *left, NODE *right);
 NODE *join_node(NODE *joinattr1, int op, NODE *joinattr2);
 NODE *qualattr_node(char *relname, char *attrname);
 NODE *primattr_node(char *attrname, int nbuckets);
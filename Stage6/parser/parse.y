@@ -41,6 +41,7 @@ static NODE *parse_tree;                // root of parse tree
 		RW_WHERE
 		RW_INSERT
 		RW_DELETE
+		RW_VACUUM
 		RW_PRIMARY
 		RW_NUMBUCKETS
 		RW_ALL
@@ -85,17 +86,19 @@ static NODE *parse_tree;                // root of parse tree
 		create
 		destroy
 		build
-/*
 		rebuild
-*/
 		drop
 		load
 		print
+		vacuum
 		help
 		quit
 		opt_primary_attr
 		opt_where
 		qual
+		cond
+		cond_term
+		cond_factor
 		selection
 		join
 		non_mt_qualattr_list
@@ -148,12 +151,11 @@ command
 	| create
 	| destroy
 	| build
-/*
 	| rebuild
-*/
 	| drop
 	| load
 	| print
+	| vacuum
 	| help
 	| quit
 	| nothing
@@ -276,14 +278,12 @@ build
 	}
 	;
 
-/*
 rebuild
 	: RW_REBUILD string '(' string ')' RW_NUMBUCKETS T_EQ T_INT
 	{
 		$$ = rebuild_node($2, $4, $8);
 	}
 	;
-*/
 
 drop
 	: RW_DROP string '(' string ')'
@@ -309,6 +309,13 @@ print
 	}
 	;
 
+vacuum
+	: RW_VACUUM RW_TABLE string
+	{
+		$$ = vacuum_node($3);
+	}
+	;
+
 help
 	: RW_HELP opt_relname
 	{
@@ -368,10 +375,39 @@ opt_where
 	;
 
 qual
-	: selection
+	: cond
 	| join
 	;
 
+/* AND binds tighter than OR, NOT tighter than both */
+cond
+	: cond RW_OR cond_term
+	{
+		$$ = cond_node(RW_OR, $1, $3);
+	}
+	| cond_term
+	;
+
+cond_term
+	: cond_term RW_AND cond_factor
+	{
+		$$ = cond_node(RW_AND, $1, $3);
+	}
+	| cond_factor
+	;
+
+cond_factor
+	: RW_NOT cond_factor
+	{
+		$$ = cond_node(RW_NOT, $2, NULL);
+	}
+	| '(' cond ')'
+	{
+		$$ = $2;
+	}
+	| selection
+	;
+
 selection
 	: qualattr op value
 	{
@@ -10,14 +10,17 @@
 
 class Partition {
  public:
-  Partition(HeapFileScan *rel,              // name of heap file to partition
+  Partition(HeapFileScan *rel,              // scan of heap file to partition
+                                            // (best opened for bulk access)
 	    const string & fileName,             // (base) name of heap file
 	    const int P,                      // number of partitions
 	    const int (*hashfcn)(const Record & rec,
 				 const int P),  
 	                               // hash function to use in partitioning
 	    string* &partName,           // names of partitioned heap files
-	    Status &status);            // create partitions of file
+	    Status &status,             // create partitions of file
+	    const Status (*keep)(const Record & rec) = NULL);
+	                               // takes partition 0 instead of a file
   ~Partition();                         // destroy partitions
 
  private:
@@ -5,6 +5,21 @@
 
 enum JoinType {NLJoin, SMJoin, HashJoin};
 
+//
+// A WHERE clause with several comparisons: a comparison of attr with
+// its value (attrType and attrValue as for the attr of QU_Select), or
+// the AND or OR of left and right, or NOT left.
+//
+
+typedef struct condInfo {
+  CondKind kind;
+  attrInfo attr;                        // COND_CMP
+  Operator op;
+  struct condInfo *left;                // the operands otherwise
+  struct condInfo *right;
+} condInfo;
+
+
 //
 // Prototypes for query layer functions
 //
@@ -17,6 +32,11 @@ const Status QU_Select(const string & result,
 		       const Operator op, 
 		       const char *attrValue);
 
+const Status QU_Select(const string & result, 
+		       const int projCnt, 
+		       const attrInfo projNames[],
+		       const condInfo *cond);
+
 const Status QU_Join(const string & result, 
 		     const int projCnt, 
 		     const attrInfo projNames[],
@@ -34,4 +54,12 @@ const Status QU_Delete(const string & relation,
 		       const Datatype type, 
 		       const char *attrValue);
 
+const Status QU_Delete(const string & relation, 
+		       const condInfo *cond);
+
+// translate cond into a condition for HeapFileScan::startScan, and
+// free the result
+const Status QU_ScanCond(const condInfo *cond, ScanCond *&scanCond);
+void QU_FreeScanCond(ScanCond *scanCond);
+
 #endif
@@ -0,0 +1,179 @@
+#ifndef REPLACER_H
+#define REPLACER_H
+
+#include <pthread.h>
+#include <list>
+#include <map>
+#include <set>
+#include "buf.h"
+
+// Replacement policies for the buffer manager.
+//
+// A BufReplacer decides which frame BufMgr::allocBuf reuses.  BufMgr
+// tells it when a page is brought into a frame (loaded), referenced
+// again (accessed) and when a page leaves a frame (removed).  victim()
+// picks a frame and returns it pinned; if the frame still holds a page,
+// BufMgr writes it out and then reports it as removed.
+//
+// Every replacer has its own latch.  BufMgr never holds a hash table or
+// frame latch when calling a replacer, while victim() takes frame
+// latches under the replacer latch.
+
+class BufReplacer
+{
+public:
+  BufReplacer(BufDesc* bufTable, const int bufs);
+  virtual ~BufReplacer();
+
+  virtual const char* name() const = 0;
+
+  // page pageNo of file was read into frame, or the frame got a new page
+  virtual void loaded(const int frame, const File* file, const int pageNo) = 0;
+
+  // the page in frame was found in the pool again
+  virtual void accessed(const int frame) = 0;
+
+  // the page in frame left the pool. evicted is true if it was replaced
+  // by allocBuf, false if it was flushed or disposed of.
+  virtual void removed(const int frame, const bool evicted) = 0;
+
+  // choose a frame to reuse and pin it. returns false if all frames
+  // are pinned
+  virtual bool victim(int & frame) = 0;
+
+  // create the replacer for policy (one of the names returned by name())
+  // returns NULL if the policy is unknown
+  static BufReplacer* create(const string & policy, BufDesc* bufTable,
+			     const int bufs);
+
+protected:
+  BufDesc*	  bufTable;  // frame descriptors of the buffer manager
+  int		  numBufs;   // number of frames
+  pthread_mutex_t latch;     // protects the state of the replacer
+
+  // pin the frame if nobody else has it pinned
+  bool tryPin(const int frame);
+};
+
+
+// identifies a page that is no longer in the pool
+struct PageKey
+{
+  const File*	file;
+  int		pageNo;
+
+  bool operator < (const PageKey & other) const
+  {
+    return file < other.file || (file == other.file && pageNo < other.pageNo);
+  }
+};
+
+// bounded FIFO of pages that were evicted, with a value kept per page
+class GhostList
+{
+public:
+  GhostList(const unsigned int capacity) : capacity(capacity) {}
+
+  void insert(const PageKey & key, const long value);
+  bool remove(const PageKey & key, long & value); // true if key was there
+
+private:
+  typedef list<PageKey> FifoList;
+  unsigned int		  capacity;
+  FifoList		  fifo;  // front is the most recent
+  map<PageKey, pair<FifoList::iterator, long> > index;
+};
+
+
+// CLOCK: the second chance algorithm BufMgr has always used
+
+class ClockReplacer : public BufReplacer
+{
+public:
+  ClockReplacer(BufDesc* bufTable, const int bufs);
+  ~ClockReplacer();
+
+  const char* name() const { return "clock"; }
+  void loaded(const int frame, const File* file, const int pageNo);
+  void accessed(const int frame);
+  void removed(const int frame, const bool evicted);
+  bool victim(int & frame);
+
+private:
+  unsigned int	clockHand;
+  char*		refbit;   // has the frame been referenced recently
+};
+
+
+// 2Q (Johnson and Shasha).  A page read for the first time goes to the
+// FIFO queue A1in and is evicted from there unless it is referenced
+// again after it has left.  Evicted A1in pages are remembered in the
+// ghost queue A1out; a miss on a page in A1out puts it into the LRU
+// list Am of hot pages.  A single scan therefore only cycles through
+// A1in and leaves Am alone.
+
+class TwoQReplacer : public BufReplacer
+{
+public:
+  TwoQReplacer(BufDesc* bufTable, const int bufs);
+  ~TwoQReplacer();
+
+  const char* name() const { return "2q"; }
+  void loaded(const int frame, const File* file, const int pageNo);
+  void accessed(const int frame);
+  void removed(const int frame, const bool evicted);
+  bool victim(int & frame);
+
+private:
+  enum { FREE, A1IN, AM, NQUEUES };
+
+  int		kin;         // target size of A1in
+  int*		prev;        // doubly linked queues threaded through frames
+  int*		next;
+  char*		queue;       // queue the frame is on
+  PageKey*	page;        // page held by the frame
+  int		head[NQUEUES];  // most recently inserted frame
+  int		tail[NQUEUES];  // least recently inserted frame
+  int		size[NQUEUES];
+  GhostList	a1out;
+
+  void unlink(const int frame);
+  void pushFront(const int q, const int frame);
+  bool victimFrom(const int q, int & frame);
+};
+
+
+// LRU-K with K = 2 (O'Neil, O'Neil and Weikum).  The victim is the page
+// whose second most recent reference is the oldest; pages referenced only
+// once go first.  Reference history of evicted pages is retained for a
+// while, so a page that keeps coming back is recognized as hot.
+
+class LRUKReplacer : public BufReplacer
+{
+public:
+  LRUKReplacer(BufDesc* bufTable, const int bufs);
+  ~LRUKReplacer();
+
+  const char* name() const { return "lru2"; }
+  void loaded(const int frame, const File* file, const int pageNo);
+  void accessed(const int frame);
+  void removed(const int frame, const bool evicted);
+  bool victim(int & frame);
+
+private:
+  typedef pair<pair<long, long>, int> Entry;  // ((hist2, hist1), frame)
+
+  long		clock;       // logical time, advanced on every reference
+  long*		hist1;       // time of last reference, 0 if frame is free
+  long*		hist2;       // time of the reference before that, or 0
+  PageKey*	page;        // page held by the frame
+  set<Entry>	order;       // frames ordered by backward 2-distance
+  GhostList	history;     // retained hist1 of evicted pages
+
+  Entry entry(const int frame) const
+  {
+    return Entry(pair<long, long>(hist2[frame], hist1[frame]), frame);
+  }
+};
+
+#endif
@@ -27,6 +27,18 @@ const Status UT_Load(const string & relation,
 
 const Status UT_Print(string relation);
 
+const Status UT_Vacuum(const string & relation);
+
+const Status UT_BuildIndex(const string & relation,
+			   const string & attrName);
+
+const Status UT_RebuildIndex(const string & relation,
+			     const string & attrName,
+			     const int numBuckets);
+
+const Status UT_DropIndex(const string & relation,
+			  const string & attrName);     // attrName may be empty
+
 void   UT_Quit(void);
 
 #endif